@@ -2,6 +2,16 @@
 #include <string>
 #include <map>
 #include <vector>
+#include <queue>
+#include <functional>
+#include <stdexcept>
+
+// LAB_STAT(x) выполняет x только в сборке со счётчиками заказов (без -DLAB_NO_STATS)
+#ifndef LAB_NO_STATS
+#define LAB_STAT(x) x
+#else
+#define LAB_STAT(x)
+#endif
 
 class Order
 { // хранит данные заказ
@@ -39,6 +49,11 @@ public:
         recipe["Fries"] = {{"potato", 2}, {"salt", 1}};
     }
 
+    bool hasDish(const std::string &dish) const
+    { // Есть ли такое блюдо в меню
+        return recipe.count(dish) != 0;
+    }
+
     bool canCook(const std::string &dish)
     { // Проверяем, можно ли приготовить заказ
         if (!recipe.count(dish))
@@ -59,13 +74,41 @@ public:
         }
         return dishes[dish];
     }
+
+    void restock(const std::string &ingredient, int amount)
+    { // Подвоз продуктов на склад
+        ingredients[ingredient] += amount;
+    }
+};
+
+#ifndef LAB_NO_STATS
+struct RestaurantStats
+{ // счётчики обработки заказов
+    int orders = 0;        // всего заказов
+    int cooked = 0;        // приготовлено блюд
+    int unknownDish = 0;   // отказ: такого блюда нет
+    int noIngredients = 0; // отказ: не хватает ингредиентов
+    int cookMinutes = 0;   // суммарное время готовки
+
+    void print(std::ostream &out) const
+    {
+        out << "Заказов: " << orders
+            << ", приготовлено: " << cooked
+            << ", нет блюда: " << unknownDish
+            << ", нет ингредиентов: " << noIngredients
+            << ", минут готовки: " << cookMinutes << "\n";
+    }
 };
+#endif
 
 class Restaurant
 { // Singleton, управляет заказами и кухней
 private:
     static Restaurant *instance; // статическое поле Singleton
     Kitchen kitchen;             // кухня — контейнеризируемый класс
+#ifndef LAB_NO_STATS
+    RestaurantStats stats; // счётчики заказов
+#endif
 
     Restaurant() {} // приватный конструктор
 
@@ -81,20 +124,144 @@ public:
     { // Метод обработки заказа
         std::cout << "Стол #" << order.tableId
                   << " заказал: " << order.dishName << "\n";
+        LAB_STAT(stats.orders++);
 
         if (!kitchen.canCook(order.dishName))
         {
+            LAB_STAT((kitchen.hasDish(order.dishName) ? stats.noIngredients : stats.unknownDish)++);
             std::cout << "Блюдо нельзя приготовить, не хватает ингредиентов\n";
             return;
         }
 
         int time = kitchen.cook(order.dishName);
+        LAB_STAT(stats.cooked++);
+        LAB_STAT(stats.cookMinutes += time);
         std::cout << "Блюдо будет готово через " << time << " минут\n";
     }
+
+#ifndef LAB_NO_STATS
+    const RestaurantStats &getStats() const { return stats; }
+#endif
 };
 
 Restaurant *Restaurant::instance = nullptr;
 
+class Simulation
+{ // Дискретно-событийная модель работы кухни: время идёт от события к событию
+private:
+    enum EventType
+    {
+        ARRIVAL,   // пришёл заказ
+        COOK_DONE, // повар закончил блюдо
+        RESTOCK    // подвезли продукты
+    };
+
+    struct Event
+    {
+        int time;         // минута от начала дня
+        long long seq;    // порядок добавления, чтобы одновременные события шли по очереди
+        EventType type;
+        std::string name; // блюдо или ингредиент
+        int value;        // номер стола или количество продукта
+
+        bool operator>(const Event &e) const
+        {
+            return time != e.time ? time > e.time : seq > e.seq;
+        }
+    };
+
+    Kitchen kitchen;
+    int freeCooks;
+    long long nextSeq = 0;
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events;
+    std::queue<std::pair<int, Order>> waiting; // заказы ждут повара: (время прихода, заказ)
+
+    int served = 0;          // приготовлено блюд
+    int rejected = 0;        // нельзя приготовить
+    long long totalWait = 0; // сколько заказы ждали повара, минут
+    int finishTime = 0;      // когда освободился последний повар
+
+    void push(int time, EventType type, const std::string &name, int value)
+    {
+        events.push({time, nextSeq++, type, name, value});
+    }
+
+    void startWaiting(int now)
+    { // Раздаём ожидающие заказы свободным поварам
+        while (freeCooks > 0 && !waiting.empty())
+        {
+            int arrived = waiting.front().first;
+            Order order = waiting.front().second;
+            waiting.pop();
+
+            if (!kitchen.canCook(order.dishName))
+            {
+                rejected++;
+                continue;
+            }
+
+            freeCooks--;
+            totalWait += now - arrived;
+            push(now + kitchen.cook(order.dishName), COOK_DONE, order.dishName, order.tableId);
+        }
+    }
+
+public:
+    Simulation(int cooks) : freeCooks(cooks)
+    {
+        if (cooks <= 0) // без поваров заказы ждали бы вечно
+            throw std::invalid_argument("нужен хотя бы один повар");
+    }
+
+    Kitchen &getKitchen() { return kitchen; }
+
+    void addOrder(int time, const Order &order)
+    {
+        push(time, ARRIVAL, order.dishName, order.tableId);
+    }
+
+    void addRestock(int time, const std::string &ingredient, int amount)
+    {
+        push(time, RESTOCK, ingredient, amount);
+    }
+
+    void run()
+    { // Обрабатываем события по времени, пока они не кончатся
+        while (!events.empty())
+        {
+            Event e = events.top();
+            events.pop();
+
+            if (e.type == ARRIVAL)
+            {
+                waiting.push({e.time, Order(e.name, e.value)});
+            }
+            else if (e.type == COOK_DONE)
+            {
+                freeCooks++;
+                served++;
+                finishTime = e.time;
+            }
+            else if (e.type == RESTOCK)
+            {
+                kitchen.restock(e.name, e.value);
+            }
+
+            startWaiting(e.time);
+        }
+    }
+
+    void printResult() const
+    {
+        std::cout << "Приготовлено: " << served
+                  << ", отказов: " << rejected
+                  << ", не дождались повара: " << waiting.size()
+                  << ", среднее ожидание повара: "
+                  << (served ? static_cast<double>(totalWait) / served : 0) << " мин."
+                  << ", кухня закончила на " << finishTime << " минуте\n";
+    }
+};
+
 int main()
 {
     Restaurant *r = Restaurant::getInstance();
@@ -115,5 +282,22 @@ int main()
     r->processOrder(o6);
     r->processOrder(o7);
 
+#ifndef LAB_NO_STATS
+    r->getStats().print(std::cout);
+#endif
+
+    // Тот же набор заказов за час с двумя поварами и подвозом мяса
+    Simulation sim(2);
+    sim.addOrder(0, o1);
+    sim.addOrder(5, o2);
+    sim.addOrder(10, o3);
+    sim.addOrder(12, o4);
+    sim.addOrder(20, o5);
+    sim.addOrder(25, o6);
+    sim.addOrder(40, o7);
+    sim.addRestock(30, "meat", 5);
+    sim.run();
+    sim.printResult();
+
     return 0;
 }
@@ -2,27 +2,178 @@
 #include <vector>
 #include <string>
 #include <limits>
+#include <deque>
+#include <map>
+#include <set>
+#include <cstdint>
+#include <algorithm>
 #include <iostream>
 using namespace std;
 
-enum class RoomType
+// Счётчики заселений и отказов; сборка с -DLAB_NO_STATS обходится без них
+#ifndef LAB_NO_STATS
+#define LAB_STAT(x) x
+#else
+#define LAB_STAT(x)
+#endif
+
+enum class RoomType : uint8_t
 {
     SINGLE = 1,
     DOUBLE,
     LUX
 };
 
+string roomTypeToString(RoomType t)
+{
+    switch (t)
+    {
+    case RoomType::SINGLE:
+        return "Single";
+    case RoomType::DOUBLE:
+        return "Double";
+    case RoomType::LUX:
+        return "Lux";
+    }
+    return "Unknown";
+}
+
+// Декодирует символ UTF-8, начинающийся с позиции i, и сдвигает i за него.
+// Буквы фамилий занимают один-два байта, трёхбайтовые нужны для
+// типографского апострофа ’; на четырёхбайтовые и ошибки возвращает -1.
+int decodeUtf8(const string &s, size_t &i)
+{
+    unsigned char b = static_cast<unsigned char>(s[i]);
+    if (b < 0x80)
+    {
+        i += 1;
+        return b;
+    }
+    if (b >= 0xC2 && b <= 0xDF && i + 1 < s.size())
+    {
+        unsigned char b2 = static_cast<unsigned char>(s[i + 1]);
+        if ((b2 & 0xC0) == 0x80)
+        {
+            i += 2;
+            return ((b & 0x1F) << 6) | (b2 & 0x3F);
+        }
+    }
+    if (b >= 0xE0 && b <= 0xEF && i + 2 < s.size())
+    {
+        unsigned char b2 = static_cast<unsigned char>(s[i + 1]);
+        unsigned char b3 = static_cast<unsigned char>(s[i + 2]);
+        if ((b2 & 0xC0) == 0x80 && (b3 & 0xC0) == 0x80)
+        {
+            int cp = ((b & 0x0F) << 12) | ((b2 & 0x3F) << 6) | (b3 & 0x3F);
+            if (cp >= 0x800 && (cp < 0xD800 || cp > 0xDFFF))
+            {
+                i += 3;
+                return cp;
+            }
+        }
+    }
+    return -1;
+}
+
+// Типографский апостроф (O’Brien) считаем обычным
+const int RIGHT_QUOTE = 0x2019;
+
+bool isSurnameChar(int cp)
+{
+    return (cp >= 'a' && cp <= 'z') || (cp >= 'A' && cp <= 'Z') ||
+           (cp >= 0x00C0 && cp <= 0x017F && cp != 0x00D7 && cp != 0x00F7) || // Müller, José, Łukasz
+           (cp >= 0x0400 && cp <= 0x045F) || // основная кириллица, включая Ё/ё
+           cp == '-' || cp == '\'' || cp == RIGHT_QUOTE;
+}
+
+// Длина фамилии в символах (а не в байтах) или -1,
+// если в ней есть что-то кроме букв, '-' и '\''.
+int surnameLength(const string &s)
+{
+    int len = 0;
+    size_t i = 0;
+    while (i < s.size())
+    {
+        int cp = decodeUtf8(s, i);
+        if (cp < 0 || !isSurnameChar(cp))
+            return -1;
+        len++;
+    }
+    return len;
+}
+
+// Строчная пара для заглавных букв латиницы и кириллицы
+int toLowerLetter(int cp)
+{
+    if (cp >= 'A' && cp <= 'Z')
+        return cp + ('a' - 'A');
+    if (cp >= 0x00C0 && cp <= 0x00DE && cp != 0x00D7) // À–Þ
+        return cp + 0x20;
+    if (cp == 0x0130) // İ
+        return 'i';
+    if (cp == 0x0178) // Ÿ
+        return 0x00FF;
+    // в Latin Extended-A заглавная и строчная стоят рядом:
+    // Ā–ķ и Ŋ–ŷ — заглавные на чётных местах, Ĺ–ň и Ź–ž — на нечётных
+    if ((cp >= 0x0100 && cp <= 0x0137) || (cp >= 0x014A && cp <= 0x0177))
+        return (cp % 2 == 0) ? cp + 1 : cp;
+    if ((cp >= 0x0139 && cp <= 0x0148) || (cp >= 0x0179 && cp <= 0x017E))
+        return (cp % 2 == 1) ? cp + 1 : cp;
+    if (cp >= 0x0410 && cp <= 0x042F) // А–Я
+        return cp + 0x20;
+    if (cp >= 0x0400 && cp <= 0x040F) // Ѐ–Џ, в том числе Ё
+        return cp + 0x50;
+    if (cp == RIGHT_QUOTE)
+        return '\'';
+    return cp;
+}
+
+// Ключ для поиска по фамилии: всё в нижнем регистре,
+// чтобы "Иванов", "ИВАНОВ" и "иванов" находили одного клиента.
+string surnameKey(const string &s)
+{
+    string key;
+    key.reserve(s.size());
+    size_t i = 0;
+    while (i < s.size())
+    {
+        int cp = decodeUtf8(s, i);
+        if (cp < 0)
+            return s; // не наш UTF-8 — сравниваем как есть
+
+        cp = toLowerLetter(cp);
+
+        if (cp < 0x80)
+        {
+            key += static_cast<char>(cp);
+        }
+        else if (cp < 0x800)
+        {
+            key += static_cast<char>(0xC0 | (cp >> 6));
+            key += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+        else
+        {
+            key += static_cast<char>(0xE0 | (cp >> 12));
+            key += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            key += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+    }
+    return key;
+}
+
 class Room
 {
 private:
-    int id;
+    // поля от больших к меньшим, чтобы не было выравнивания: 16 байт вместо 24
     double price;
+    int id;
     RoomType type;
     bool occupied;
 
 public:
     Room(int id, double price, RoomType type)
-        : id(id), price(price), type(type), occupied(false) {}
+        : price(price), id(id), type(type), occupied(false) {}
 
     ~Room()
     {
@@ -53,11 +204,11 @@ private:
 
 public:
     Client(string s, int roomId, int days)
-        : surname(s), roomId(roomId), days(days) {}
+        : surname(move(s)), roomId(roomId), days(days) {}
 
     ~Client() {}
 
-    string getSurname() const { return surname; }
+    const string &getSurname() const { return surname; }
     int getRoomId() const { return roomId; }
     int getDays() const { return days; }
 
@@ -67,122 +218,262 @@ public:
     }
 };
 
+// Номер клиента в Hotel::clients. Клиенты только добавляются,
+// поэтому номер не меняется всё время работы программы.
+using ClientHandle = uint32_t;
+
+#ifndef LAB_NO_STATS
+struct HotelStats
+{
+    int registered = 0;  // заселено клиентов
+    int roomTaken = 0;   // отказ: номер занят
+    int roomMissing = 0; // отказ: номера нет
+
+    void print(ostream &out) const
+    {
+        out << "Заселено: " << registered
+            << ", отказов (номер занят): " << roomTaken
+            << ", отказов (номера нет): " << roomMissing << "\n";
+    }
+};
+#endif
+
 class Hotel
 {
 private:
     vector<Room> rooms;
-    vector<Client> clients;
+    map<int, size_t> roomIndex; // номер комнаты -> позиция в rooms
+    // свободные комнаты каждого типа: (цена, позиция в rooms), по возрастанию цены
+    map<RoomType, set<pair<double, size_t>>> freeRooms;
+    // deque растёт блоками и не перемещает уже добавленных клиентов,
+    // поэтому ссылки и номера клиентов остаются действительными
+    deque<Client> clients;
+    multimap<string, ClientHandle> surnameIndex; // ключ фамилии -> клиент (ключ хранится только здесь)
+#ifndef LAB_NO_STATS
+    HotelStats stats;
+#endif
 
 public:
     Hotel() {}
     ~Hotel() {}
 
-    bool addRoom(const Room &r)
+    bool addRoom(const Room &r, ostream &out = cout)
     {
-        for (const auto &room : rooms)
+        if (roomIndex.count(r.getId()))
         {
-            if (room.getId() == r.getId())
-            {
-                cout << "Ошибка: комната с таким номером уже существует.\n";
-                return false;
-            }
+            out << "Ошибка: комната с таким номером уже существует.\n";
+            return false;
         }
+        roomIndex[r.getId()] = rooms.size();
         rooms.push_back(r);
+        if (!r.isOccupied())
+            freeRooms[r.getType()].emplace(r.getPrice(), rooms.size() - 1);
         return true;
     }
 
+    const Room *findRoom(int id) const
+    {
+        auto it = roomIndex.find(id);
+        if (it == roomIndex.end())
+            return nullptr;
+        return &rooms[it->second];
+    }
+
     bool registerClient(const string &surname, int roomId, int days)
     {
-        for (auto &r : rooms)
+        auto it = roomIndex.find(roomId);
+        if (it == roomIndex.end())
         {
-            if (r.getId() == roomId)
-            {
-                if (!r.isOccupied())
-                {
-                    r.occupy();
-                    clients.emplace_back(surname, roomId, days);
-                    return true;
-                }
-                else
-                {
-                    return false;
-                }
-            }
+            LAB_STAT(stats.roomMissing++);
+            return false;
         }
-        return false;
+
+        Room &r = rooms[it->second];
+        if (!r.occupy())
+        {
+            LAB_STAT(stats.roomTaken++);
+            return false;
+        }
+        LAB_STAT(stats.registered++);
+        freeRooms[r.getType()].erase({r.getPrice(), it->second});
+
+        ClientHandle h = static_cast<ClientHandle>(clients.size());
+        clients.emplace_back(surname, roomId, days);
+        surnameIndex.emplace(surnameKey(clients.back().getSurname()), h);
+        return true;
     }
 
-    void showFreeRooms() const
+    const Client &getClient(ClientHandle h) const { return clients[h]; }
+
+    // Не больше limit свободных комнат типа t с ценой от minPrice до maxPrice,
+    // начиная с самой дешёвой. Работает за O(log n + limit).
+    vector<const Room *> findFreeRooms(RoomType t, double minPrice, double maxPrice, size_t limit) const
+    {
+        vector<const Room *> result;
+        auto it = freeRooms.find(t);
+        if (it == freeRooms.end())
+            return result;
+
+        for (auto f = it->second.lower_bound({minPrice, 0});
+             f != it->second.end() && f->first <= maxPrice && result.size() < limit; ++f)
+            result.push_back(&rooms[f->second]);
+        return result;
+    }
+
+    // Сколько заплатит клиент за всё проживание
+    double clientCost(const Client &c) const
+    {
+        const Room *r = findRoom(c.getRoomId());
+        return r ? c.calcCost(r->getPrice()) : 0;
+    }
+
+    double totalRevenue() const
+    {
+        double sum = 0;
+        for (const auto &c : clients)
+            sum += clientCost(c);
+        return sum;
+    }
+
+    map<RoomType, double> revenueByType() const
+    {
+        map<RoomType, double> result;
+        for (const auto &c : clients)
+        {
+            const Room *r = findRoom(c.getRoomId());
+            if (r)
+                result[r->getType()] += c.calcCost(r->getPrice());
+        }
+        return result;
+    }
+
+    // Доля занятых номеров от 0 до 1
+    double occupancyRate() const
+    {
+        if (rooms.empty())
+            return 0;
+        size_t occupied = 0;
+        for (const auto &r : rooms)
+            if (r.isOccupied())
+                occupied++;
+        return static_cast<double>(occupied) / rooms.size();
+    }
+
+    // n клиентов с самой большой суммой за проживание, по убыванию
+    vector<ClientHandle> topClients(size_t n) const
+    {
+        vector<pair<double, ClientHandle>> costs;
+        costs.reserve(clients.size());
+        for (size_t i = 0; i < clients.size(); i++)
+            costs.emplace_back(clientCost(clients[i]), static_cast<ClientHandle>(i));
+
+        n = min(n, costs.size());
+        partial_sort(costs.begin(), costs.begin() + n, costs.end(),
+                     [](const pair<double, ClientHandle> &a, const pair<double, ClientHandle> &b)
+                     { return a.first > b.first; });
+
+        vector<ClientHandle> result;
+        for (size_t i = 0; i < n; i++)
+            result.push_back(costs[i].second);
+        return result;
+    }
+
+    void showReport(size_t topN, ostream &out = cout) const
     {
-        cout << "\nСвободные номера:\n";
+        out << "\nОжидаемая выручка: " << totalRevenue() << " руб.\n";
+        for (const auto &t : revenueByType())
+            out << "  " << roomTypeToString(t.first) << ": " << t.second << " руб.\n";
+        out << "Загрузка: " << occupancyRate() * 100 << "%\n";
+
+        out << "Лучшие клиенты:\n";
+        for (ClientHandle h : topClients(topN))
+        {
+            const Client &c = getClient(h);
+            out << "  " << c.getSurname() << " — " << clientCost(c) << " руб.\n";
+        }
+#ifndef LAB_NO_STATS
+        stats.print(out);
+#endif
+    }
+
+    void showFreeRooms(ostream &out = cout) const
+    {
+        out << "\nСвободные номера:\n";
         for (const auto &r : rooms)
         {
             if (!r.isOccupied())
             {
-                cout << "Комната " << r.getId()
-                     << " — цена: " << r.getPrice() << " руб.\n";
+                out << "Комната " << r.getId()
+                    << " — цена: " << r.getPrice() << " руб.\n";
             }
         }
     }
 
-    bool showClientCost(const string &surname)
+    bool showClientCost(const string &surname, ostream &out = cout)
     {
-        for (const auto &c : clients)
+        auto range = surnameIndex.equal_range(surnameKey(surname));
+        for (auto it = range.first; it != range.second; ++it)
         {
-            if (c.getSurname() == surname)
+            const Client &c = getClient(it->second);
+            const Room *r = findRoom(c.getRoomId());
+            if (r)
             {
-                for (const auto &r : rooms)
-                {
-                    if (r.getId() == c.getRoomId())
-                    {
-                        cout << "Стоимость проживания: "
-                             << c.calcCost(r.getPrice()) << " руб.\n";
-                        return true;
-                    }
-                }
+                out << "Стоимость проживания: "
+                    << c.calcCost(r->getPrice()) << " руб.\n";
+                return true;
             }
         }
         return false;
     }
 };
 
+// Сессия оператора стойки: читает из in, пишет в out.
+// Отель не принадлежит меню, его могут делить несколько сессий.
 class Menu
 {
 private:
-    Hotel hotel;
+    Hotel &hotel;
+    istream &in;
+    ostream &out;
 
 public:
+    Menu(Hotel &hotel, istream &in, ostream &out)
+        : hotel(hotel), in(in), out(out) {}
+
     void run()
     {
         while (true)
         {
 
-            cout << "\n===== МЕНЮ =====\n"
-                 << "1. Добавить номер\n"
-                 << "2. Зарегистрировать клиента\n"
-                 << "3. Показать свободные номера\n"
-                 << "4. Узнать стоимость по фамилии\n"
-                 << "5. Выход\n"
-                 << "Ваш выбор: ";
+            out << "\n===== МЕНЮ =====\n"
+                << "1. Добавить номер\n"
+                << "2. Зарегистрировать клиента\n"
+                << "3. Показать свободные номера\n"
+                << "4. Узнать стоимость по фамилии\n"
+                << "5. Отчёт по выручке и загрузке\n"
+                << "6. Подобрать свободный номер\n"
+                << "7. Выход\n"
+                << "Ваш выбор: ";
 
             int choice;
             string input;
 
             while (true)
             {
-                getline(cin, input);
+                if (!getline(in, input))
+                    return;
 
                 try
                 {
                     size_t pos;
                     choice = stoi(input, &pos);
-                    if (pos != input.size() || choice < 1 || choice > 5)
+                    if (pos != input.size() || choice < 1 || choice > 7)
                         throw invalid_argument("неверный ввод");
                     break;
                 }
                 catch (...)
                 {
-                    cout << "Ошибка! Введите целое число от 1 до 5.\n";
+                    out << "Ошибка! Введите целое число от 1 до 7.\n";
                 }
             }
 
@@ -191,10 +482,14 @@ public:
             else if (choice == 2)
                 registerClientMenu();
             else if (choice == 3)
-                hotel.showFreeRooms();
+                hotel.showFreeRooms(out);
             else if (choice == 4)
                 showCostMenu();
             else if (choice == 5)
+                hotel.showReport(5, out);
+            else if (choice == 6)
+                findRoomMenu();
+            else if (choice == 7)
                 break;
         }
     }
@@ -209,9 +504,10 @@ private:
 
         while (true)
         {
-            cout << "Введите номер комнаты (1–999): ";
+            out << "Введите номер комнаты (1–999): ";
 
-            getline(cin, input);
+            if (!getline(in, input))
+                return;
 
             try
             {
@@ -223,27 +519,30 @@ private:
             }
             catch (...)
             {
-                cout << "Ошибка! Введите целое число от 1 до 999.\n";
+                out << "Ошибка! Введите целое число от 1 до 999.\n";
             }
         }
 
         while (true)
         {
-            cout << "Введите цену: ";
-            if (cin >> price && price < 100000 && price >= 1)
+            out << "Введите цену: ";
+            if (in >> price && price < 100000 && price >= 1)
                 break;
-            cout << "Ошибка! Введите верное значение:\n";
-            cin.clear();
-            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            if (in.eof())
+                return;
+            out << "Ошибка! Введите верное значение:\n";
+            in.clear();
+            in.ignore(numeric_limits<streamsize>::max(), '\n');
         }
 
-        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        in.ignore(numeric_limits<streamsize>::max(), '\n');
 
         while (true)
         {
-            cout << "Тип комнаты (1 — Single, 2 — Double, 3 — Lux): ";
+            out << "Тип комнаты (1 — Single, 2 — Double, 3 — Lux): ";
 
-            getline(cin, input);
+            if (!getline(in, input))
+                return;
 
             try
             {
@@ -255,12 +554,12 @@ private:
             }
             catch (...)
             {
-                cout << "Ошибка! Введите тип.\n";
+                out << "Ошибка! Введите тип.\n";
             }
         }
 
-        if (hotel.addRoom(Room(id, price, static_cast<RoomType>(type))))
-            cout << "Комната добавлена.\n";
+        if (hotel.addRoom(Room(id, price, static_cast<RoomType>(type)), out))
+            out << "Комната добавлена.\n";
     }
 
     void registerClientMenu()
@@ -271,41 +570,35 @@ private:
 
         while (true)
         {
-            cout << "Введите фамилию клиента (макс 50 символов, только буквы, '-' или '''): ";
-            cin >> surname;
+            out << "Введите фамилию клиента (макс 50 символов, только буквы, '-' или '''): ";
+            if (!(in >> surname))
+                return;
 
-            if (surname.length() > 50)
-            {
-                cout << "Ошибка: фамилия слишком длинная.\n";
-                continue;
-            }
+            int len = surnameLength(surname);
 
-            bool valid = true;
-            for (char c : surname)
+            if (len < 0)
             {
-                if (!(isalpha(static_cast<unsigned char>(c)) || static_cast<unsigned char>(c) >= 128) && c != '-' && c != '\'')
-                {
-                    valid = false;
-                    break;
-                }
+                out << "Ошибка: используйте только буквы, '-' или '''.\n";
+                continue;
             }
 
-            if (!valid)
+            if (len > 50)
             {
-                cout << "Ошибка: используйте только буквы, '-' или '''.\n";
+                out << "Ошибка: фамилия слишком длинная.\n";
                 continue;
             }
 
             break;
         }
 
-        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        in.ignore(numeric_limits<streamsize>::max(), '\n');
 
         while (true)
         {
-            cout << "Введите номер комнаты (1–999): ";
+            out << "Введите номер комнаты (1–999): ";
 
-            getline(cin, input);
+            if (!getline(in, input))
+                return;
 
             try
             {
@@ -317,15 +610,16 @@ private:
             }
             catch (...)
             {
-                cout << "Ошибка! Введите целое число от 1 до 999.\n";
+                out << "Ошибка! Введите целое число от 1 до 999.\n";
             }
         }
 
         while (true)
         {
-            cout << "Введите количество дней: ";
+            out << "Введите количество дней: ";
 
-            getline(cin, input);
+            if (!getline(in, input))
+                return;
 
             try
             {
@@ -337,32 +631,88 @@ private:
             }
             catch (...)
             {
-                cout << "Ошибка! Проживание ограничено 365 днями: \n";
+                out << "Ошибка! Проживание ограничено 365 днями: \n";
             }
         }
 
         if (!hotel.registerClient(surname, id, days))
-            cout << "Ошибка: номер занят или не существует.\n";
+            out << "Ошибка: номер занят или не существует.\n";
         else
-            cout << "Клиент зарегистрирован.\n";
+            out << "Клиент зарегистрирован.\n";
     }
 
     void showCostMenu()
     {
         string surname;
-        cout << "Введите фамилию: ";
-        cin >> surname;
-        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        out << "Введите фамилию: ";
+        if (!(in >> surname))
+            return;
+        in.ignore(numeric_limits<streamsize>::max(), '\n');
 
-        if (!hotel.showClientCost(surname))
-            cout << "Клиент не найден.\n";
+        if (!hotel.showClientCost(surname, out))
+            out << "Клиент не найден.\n";
+    }
+
+    void findRoomMenu()
+    {
+        int type;
+        double maxPrice;
+        string input;
+
+        while (true)
+        {
+            out << "Тип комнаты (1 — Single, 2 — Double, 3 — Lux): ";
+
+            if (!getline(in, input))
+                return;
+
+            try
+            {
+                size_t pos;
+                type = stoi(input, &pos);
+                if (pos != input.size() || type < 1 || type > 3)
+                    throw invalid_argument("неверный ввод");
+                break;
+            }
+            catch (...)
+            {
+                out << "Ошибка! Введите тип.\n";
+            }
+        }
+
+        while (true)
+        {
+            out << "Максимальная цена: ";
+            if (in >> maxPrice && maxPrice < 100000 && maxPrice >= 1)
+                break;
+            if (in.eof())
+                return;
+            out << "Ошибка! Введите верное значение:\n";
+            in.clear();
+            in.ignore(numeric_limits<streamsize>::max(), '\n');
+        }
+
+        in.ignore(numeric_limits<streamsize>::max(), '\n');
+
+        vector<const Room *> found = hotel.findFreeRooms(static_cast<RoomType>(type), 0, maxPrice, 5);
+        if (found.empty())
+        {
+            out << "Подходящих свободных номеров нет.\n";
+            return;
+        }
+
+        out << "Самые дешёвые подходящие номера:\n";
+        for (const Room *r : found)
+            out << "Комната " << r->getId()
+                << " — цена: " << r->getPrice() << " руб.\n";
     }
 };
 
 int main()
 {
     setlocale(LC_ALL, "");
-    Menu menu;
+    Hotel hotel;
+    Menu menu(hotel, cin, cout);
     menu.run();
     return 0;
 }
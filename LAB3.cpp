@@ -3,8 +3,16 @@
 #include <string>
 #include <limits>
 #include <map>
+#include <cstdint>
 using namespace std;
 
+// Счётчики для Hotel::averagePrice; флаг -DLAB_NO_STATS выключает их
+#ifndef LAB_NO_STATS
+#define LAB_STAT(x) x
+#else
+#define LAB_STAT(x)
+#endif
+
 class IDiscount
 {
 public:
@@ -35,7 +43,25 @@ public:
     }
 };
 
-enum class RoomType
+// Скидка поверх уже действующей. Все скидки здесь пропорциональны цене,
+// поэтому вся цепочка сворачивается в один множитель при создании,
+// и calculate — одно умножение, а не цепочка виртуальных вызовов.
+class StackedDiscount : public IDiscount
+{
+private:
+    double factor;
+
+public:
+    StackedDiscount(const IDiscount *base, double p)
+        : factor((base ? base->calculate(1.0) : 1.0) * (1 - p / 100.0)) {}
+
+    double calculate(double price) const override
+    {
+        return price * factor;
+    }
+};
+
+enum class RoomType : uint8_t
 {
     SINGLE = 1,
     DOUBLE,
@@ -59,29 +85,30 @@ string roomTypeToString(RoomType t)
 class Room
 {
 private:
-    int id;
+    // поля от больших к меньшим, чтобы не было выравнивания: 32 байта вместо 40
     double price;
+    IDiscount *roomDiscount = nullptr;        // скидка на конкретную комнату
+    IDiscount *const *typeDiscount = nullptr; // ячейка в Hotel со скидкой на тип комнаты
+    int id;
     RoomType type;
-    IDiscount *roomDiscount = nullptr; // скидка на конкретную комнату
-    IDiscount *typeDiscount = nullptr; // скидка на тип комнаты
 
 public:
     Room(int id, double price, RoomType type, IDiscount *disc)
-        : id(id), price(price), type(type) {}
+        : price(price), roomDiscount(disc), id(id), type(type) {}
 
     int getId() const { return id; }
     RoomType getType() const { return type; }
 
     void setRoomDiscount(IDiscount *d) { roomDiscount = d; }
 
-    void setTypeDiscount(IDiscount *d) { typeDiscount = d; }
+    void setTypeDiscount(IDiscount *const *slot) { typeDiscount = slot; }
 
     double getPrice() const
     {
         double finalPrice = price;
 
-        if (typeDiscount)
-            finalPrice = typeDiscount->calculate(finalPrice);
+        if (typeDiscount && *typeDiscount)
+            finalPrice = (*typeDiscount)->calculate(finalPrice);
 
         if (roomDiscount)
             finalPrice = roomDiscount->calculate(finalPrice);
@@ -89,51 +116,73 @@ public:
         return finalPrice;
     }
 
-    void show() const
+    void show(ostream &out = cout) const
+    {
+        out << "Комната " << id
+            << " — тип: " << roomTypeToString(type)
+            << " — базовая цена: " << price
+            << " — цена со скидкой: " << getPrice()
+            << "\n";
+    }
+};
+
+#ifndef LAB_NO_STATS
+struct PriceStats
+{
+    long long averageCalls = 0; // сколько раз считали среднюю цену
+    long long roomsScanned = 0; // сколько комнат при этом просмотрели
+
+    void print(ostream &out) const
     {
-        cout << "Комната " << id
-             << " — тип: " << roomTypeToString(type)
-             << " — базовая цена: " << price
-             << " — цена со скидкой: " << getPrice()
-             << "\n";
+        out << "Подсчётов средней цены: " << averageCalls
+            << ", просмотрено комнат: " << roomsScanned << "\n";
     }
 };
+#endif
 
 class Hotel
 {
 private:
     vector<Room> rooms;
+    // Скидки на типы. Комнаты хранят адрес своей ячейки (элементы map
+    // не перемещаются), поэтому смена скидки на тип не трогает комнаты.
     std::map<RoomType, IDiscount *> typeDefaults;
+#ifndef LAB_NO_STATS
+    mutable PriceStats stats; // меняется и в const-методах
+#endif
 
 public:
-    bool addRoom(const Room &r)
+    Hotel() {}
+    // комнаты ссылаются на ячейки typeDefaults этого отеля
+    Hotel(const Hotel &) = delete;
+    Hotel &operator=(const Hotel &) = delete;
+
+    bool addRoom(const Room &r, ostream &out = cout)
     {
         for (const auto &room : rooms)
         {
             if (room.getId() == r.getId())
             {
-                cout << "Ошибка: номер с таким ID уже существует.\n";
+                out << "Ошибка: номер с таким ID уже существует.\n";
                 return false;
             }
         }
         rooms.push_back(r);
-        auto it = typeDefaults.find(r.getType());
-        if (it != typeDefaults.end() && it->second != nullptr)
-        {
-            rooms.back().setTypeDiscount(it->second);
-        }
+        rooms.back().setTypeDiscount(&typeDefaults[r.getType()]);
         return true;
     }
 
-    void showRooms() const
+    void showRooms(ostream &out = cout) const
     {
-        cout << "\nВсе номера:\n";
+        out << "\nВсе номера:\n";
         for (const auto &r : rooms)
-            r.show();
+            r.show(out);
     }
 
     double averagePrice() const
     {
+        LAB_STAT(stats.averageCalls++);
+        LAB_STAT(stats.roomsScanned += rooms.size());
         if (rooms.empty())
             return 0;
         double sum = 0;
@@ -142,6 +191,10 @@ public:
         return sum / rooms.size();
     }
 
+#ifndef LAB_NO_STATS
+    const PriceStats &getStats() const { return stats; }
+#endif
+
     bool setDiscountForRoom(int id, IDiscount *disc)
     {
         for (auto &room : rooms)
@@ -158,39 +211,51 @@ public:
     void setDiscountForType(RoomType type, IDiscount *disc)
     {
         typeDefaults[type] = disc;
+    }
 
-        for (auto &room : rooms)
-            if (room.getType() == type)
-                room.setTypeDiscount(disc);
+    // Добавляет p% к текущей скидке на тип комнат
+    void stackDiscountForType(RoomType type, double p)
+    {
+        auto it = typeDefaults.find(type);
+        IDiscount *base = (it != typeDefaults.end() ? it->second : nullptr);
+        setDiscountForType(type, new StackedDiscount(base, p));
     }
 };
 
+// Меню номеров и скидок для переданного отеля; main даёт ему cin/cout,
+// но ввод можно взять и из файла со сценарием.
 class Menu
 {
 private:
-    Hotel hotel;
-    NoDiscount noDisc;
+    Hotel &hotel;
+    istream &in;
+    ostream &out;
+    static NoDiscount noDisc; // общая для всех сессий: отель переживает любое меню
     PercentageDiscount disc10{10};
 
 public:
+    Menu(Hotel &hotel, istream &in, ostream &out)
+        : hotel(hotel), in(in), out(out) {}
+
     void run()
     {
         while (true)
         {
-            cout << "\n===== МЕНЮ =====\n"
-                 << "1. Добавить номер\n"
-                 << "2. Показать все номера\n"
-                 << "3. Средняя стоимость\n"
-                 << "4. Управление скидками\n"
-                 << "5. Выход\n"
-                 << "Ваш выбор: ";
+            out << "\n===== МЕНЮ =====\n"
+                << "1. Добавить номер\n"
+                << "2. Показать все номера\n"
+                << "3. Средняя стоимость\n"
+                << "4. Управление скидками\n"
+                << "5. Выход\n"
+                << "Ваш выбор: ";
 
             int choice;
             string input;
 
             while (true)
             {
-                getline(cin, input);
+                if (!getline(in, input))
+                    return;
 
                 try
                 {
@@ -202,16 +267,21 @@ public:
                 }
                 catch (...)
                 {
-                    cout << "Ошибка! Введите целое число от 1 до 5.\n";
+                    out << "Ошибка! Введите целое число от 1 до 5.\n";
                 }
             }
 
             if (choice == 1)
                 addRoomMenu();
             else if (choice == 2)
-                hotel.showRooms();
+                hotel.showRooms(out);
             else if (choice == 3)
-                cout << "Средняя цена: " << hotel.averagePrice() << endl;
+            {
+                out << "Средняя цена: " << hotel.averagePrice() << endl;
+#ifndef LAB_NO_STATS
+                hotel.getStats().print(out);
+#endif
+            }
             else if (choice == 4)
                 manageDiscountMenu();
             else if (choice == 5)
@@ -224,14 +294,14 @@ private:
     {
         int id, type;
         double price;
-        int disc;
         string input;
 
         while (true)
         {
-            cout << "Введите номер комнаты (1–999): ";
+            out << "Введите номер комнаты (1–999): ";
 
-            getline(cin, input);
+            if (!getline(in, input))
+                return;
 
             try
             {
@@ -243,27 +313,30 @@ private:
             }
             catch (...)
             {
-                cout << "Ошибка! Введите целое число от 1 до 999.\n";
+                out << "Ошибка! Введите целое число от 1 до 999.\n";
             }
         }
 
         while (true)
         {
-            cout << "Введите цену: ";
-            if (cin >> price && price < 100000 && price >= 1)
+            out << "Введите цену: ";
+            if (in >> price && price < 100000 && price >= 1)
                 break;
-            cout << "Ошибка! Введите верное значение:\n";
-            cin.clear();
-            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            if (in.eof())
+                return;
+            out << "Ошибка! Введите верное значение:\n";
+            in.clear();
+            in.ignore(numeric_limits<streamsize>::max(), '\n');
         }
 
-        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        in.ignore(numeric_limits<streamsize>::max(), '\n');
 
         while (true)
         {
-            cout << "Тип комнаты (1 — Single, 2 — Double, 3 — Lux): ";
+            out << "Тип комнаты (1 — Single, 2 — Double, 3 — Lux): ";
 
-            getline(cin, input);
+            if (!getline(in, input))
+                return;
 
             try
             {
@@ -275,19 +348,19 @@ private:
             }
             catch (...)
             {
-                cout << "Ошибка! Введите тип.\n";
+                out << "Ошибка! Введите тип.\n";
             }
         }
 
         try
         {
             Room r(id, price, (RoomType)type, &noDisc);
-            if (hotel.addRoom(r))
-                cout << "Комната добавлена.\n";
+            if (hotel.addRoom(r, out))
+                out << "Комната добавлена.\n";
         }
         catch (exception &e)
         {
-            cout << "Ошибка: " << e.what() << endl;
+            out << "Ошибка: " << e.what() << endl;
         }
     }
 
@@ -295,51 +368,56 @@ private:
     {
         while (true)
         {
-            cout << "\n=== УПРАВЛЕНИЕ СКИДКАМИ ===\n"
-                 << "1. Назначить скидку конкретной комнате\n"
-                 << "2. Назначить скидку типу комнат\n"
-                 << "3. Убрать все скидки\n"
-                 << "4. Назад\n"
-                 << "Ваш выбор: ";
+            out << "\n=== УПРАВЛЕНИЕ СКИДКАМИ ===\n"
+                << "1. Назначить скидку конкретной комнате\n"
+                << "2. Назначить скидку типу комнат\n"
+                << "3. Добавить скидку к текущей скидке типа комнат\n"
+                << "4. Убрать все скидки\n"
+                << "5. Назад\n"
+                << "Ваш выбор: ";
 
             string input;
             int ch;
 
-            getline(cin, input);
+            if (!getline(in, input))
+                return;
             try
             {
                 size_t pos;
                 ch = stoi(input, &pos);
-                if (pos != input.size() || ch < 1 || ch > 4)
+                if (pos != input.size() || ch < 1 || ch > 5)
                     throw invalid_argument("err");
             }
             catch (...)
             {
-                cout << "Ошибка выбора.\n";
+                out << "Ошибка выбора.\n";
                 continue;
             }
 
-            if (ch == 4)
+            if (ch == 5)
                 return;
 
             double p = 0;
             IDiscount *strategy = nullptr;
 
-            if (ch != 3)
+            if (ch != 4)
             {
                 while (true)
                 {
-                    cout << "Введите скидку (от 0 до 90) ";
-                    if (cin >> p && p <= 90 && p >= 0)
+                    out << "Введите скидку (от 0 до 90) ";
+                    if (in >> p && p <= 90 && p >= 0)
                         break;
-                    cout << "Ошибка! Введите верное значение:\n";
-                    cin.clear();
-                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                    if (in.eof())
+                        return;
+                    out << "Ошибка! Введите верное значение:\n";
+                    in.clear();
+                    in.ignore(numeric_limits<streamsize>::max(), '\n');
                 }
 
-                cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                in.ignore(numeric_limits<streamsize>::max(), '\n');
 
-                strategy = (p == 0 ? (IDiscount *)&noDisc : new PercentageDiscount(p));
+                if (ch != 3)
+                    strategy = (p == 0 ? (IDiscount *)&noDisc : new PercentageDiscount(p));
             }
 
             if (ch == 1)
@@ -347,9 +425,10 @@ private:
                 int id;
                 while (true)
                 {
-                    cout << "Введите номер комнаты (1–999): ";
+                    out << "Введите номер комнаты (1–999): ";
 
-                    getline(cin, input);
+                    if (!getline(in, input))
+                        return;
 
                     try
                     {
@@ -361,23 +440,24 @@ private:
                     }
                     catch (...)
                     {
-                        cout << "Ошибка! Введите целое число от 1 до 999.\n";
+                        out << "Ошибка! Введите целое число от 1 до 999.\n";
                     }
                 }
 
                 if (hotel.setDiscountForRoom(id, strategy))
-                    cout << "Скидка применена.\n";
+                    out << "Скидка применена.\n";
                 else
-                    cout << "Комната не найдена.\n";
+                    out << "Комната не найдена.\n";
             }
-            else if (ch == 2)
+            else if (ch == 2 || ch == 3)
             {
                 int t;
                 while (true)
                 {
-                    cout << "Тип комнаты (1 — Single, 2 — Double, 3 — Lux): ";
+                    out << "Тип комнаты (1 — Single, 2 — Double, 3 — Lux): ";
 
-                    getline(cin, input);
+                    if (!getline(in, input))
+                        return;
 
                     try
                     {
@@ -389,34 +469,40 @@ private:
                     }
                     catch (...)
                     {
-                        cout << "Ошибка! Введите тип.\n";
+                        out << "Ошибка! Введите тип.\n";
                     }
                 }
 
                 if (t < 1 || t > 3)
                 {
-                    cout << "Неверный тип.\n";
+                    out << "Неверный тип.\n";
                     continue;
                 }
 
-                hotel.setDiscountForType((RoomType)t, strategy);
-                cout << "Скидка применена для всех комнат этого типа.\n";
+                if (ch == 2)
+                    hotel.setDiscountForType((RoomType)t, strategy);
+                else
+                    hotel.stackDiscountForType((RoomType)t, p);
+                out << "Скидка применена для всех комнат этого типа.\n";
             }
-            else if (ch == 3)
+            else if (ch == 4)
             {
                 hotel.setDiscountForType(RoomType::SINGLE, &noDisc);
                 hotel.setDiscountForType(RoomType::DOUBLE, &noDisc);
                 hotel.setDiscountForType(RoomType::LUX, &noDisc);
-                cout << "Все скидки убраны.\n";
+                out << "Все скидки убраны.\n";
             }
         }
     }
 };
 
+NoDiscount Menu::noDisc;
+
 int main()
 {
     setlocale(LC_ALL, "");
-    Menu m;
+    Hotel hotel;
+    Menu m(hotel, cin, cout);
     m.run();
     return 0;
 }